@@ -6,6 +6,7 @@
 #include <iostream>
 #include <ctime>
 #include <set>
+#include "gray_capture.hpp"
 
 using namespace std;
 using namespace cv;
@@ -22,7 +23,8 @@ namespace {
         "{ci       | 0     | Camera ID }"
         "{dp       |       | Detector parameters file }"
         "{waitkey  | 10    | Delay for key press }"
-        "{minframes| 20    | Minimum frames required }";
+        "{minframes| 20    | Minimum frames required }"
+        "{gray     | false | Detect on single-channel frames, colour only for display }";
 }
 /**
 * @brief Reads custom ArUco detector parameters from a file and applies them to 'params'
@@ -111,6 +113,7 @@ int main(int argc, char *argv[]) {
     int dictionaryId = parser.get<int>("d");
     string outputFile = parser.get<String>(0);
     const int MIN_FRAMES = parser.get<int>("minframes");
+    bool grayInput = parser.get<bool>("gray");
 
     
     Ptr<aruco::DetectorParameters> detectorParams = aruco::DetectorParameters::create();
@@ -123,7 +126,11 @@ int main(int argc, char *argv[]) {
         }
     }
     // Open the camera specified by "ci" (default=0)
-    VideoCapture inputVideo(parser.get<int>("ci"));
+    VideoCapture inputVideo;
+    if (grayInput)
+        openCapture(inputVideo, to_string(parser.get<int>("ci")), grayInput);
+    else
+        inputVideo.open(parser.get<int>("ci"));
     if (!inputVideo.isOpened()) {
         cerr << "Failed to open video input" << endl;
         return 1;
@@ -141,15 +148,24 @@ int main(int argc, char *argv[]) {
     Size imgSize;
 
     while (inputVideo.grab()) {
-        Mat image, imageCopy;
-        // Retrieve the latest frame from the camera
-        inputVideo.retrieve(image);
-        image.copyTo(imageCopy);
-        
-        // Detect ArUco markers in the frame
+        Mat image, gray, imageCopy;
         vector<int> ids;
         vector<vector<Point2f>> corners, rejected;
-        aruco::detectMarkers(image, dictionary, corners, ids, detectorParams, rejected);
+
+        if (grayInput) {
+            // Detect on the single-channel frame and draw on the frame itself
+            if (!retrieveGray(inputVideo, image, gray))
+                break;
+            aruco::detectMarkers(gray, dictionary, corners, ids, detectorParams, rejected);
+            overlayImage(image, imageCopy);
+        } else {
+            // Retrieve the latest frame from the camera
+            inputVideo.retrieve(image);
+            image.copyTo(imageCopy);
+
+            // Detect ArUco markers in the frame
+            aruco::detectMarkers(image, dictionary, corners, ids, detectorParams, rejected);
+        }
 
         // If we found any markers, draw them on the copy
         if (ids.size() > 0)
@@ -1,12 +1,23 @@
 #include <opencv2/highgui.hpp>
 #include <opencv2/aruco.hpp>
 #include <opencv2/imgproc.hpp>
+#include <opencv2/core/utility.hpp>
 #include <iostream>
+#include <string>
+#include "gray_capture.hpp"
+
+static void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " <dictionary_id> [video_source] [--gray] [--gst] [--headless]" << std::endl;
+    std::cerr << "  video_source  camera index or video file (default: 0)" << std::endl;
+    std::cerr << "  --gray        detect on single-channel frames, colour only for display" << std::endl;
+    std::cerr << "  --gst         use the GStreamer pipeline in colour mode too (BGR output)" << std::endl;
+    std::cerr << "  --headless    no display, print detection and timing summary" << std::endl;
+}
 
 int main(int argc, char** argv) {
-    // Check if exactly 1 argument is provided (besides the program name)
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <dictionary_id>" << std::endl;
+    // Dictionary ID is required; video source and flags are optional
+    if (argc < 2) {
+        printUsage(argv[0]);
         return 1;
     }
 
@@ -16,36 +27,90 @@ int main(int argc, char** argv) {
         std::cerr << "Invalid dictionary ID. Use a number between 0 and 16." << std::endl;
         return 1;
     }
+
+    std::string source = "0";
+    bool grayInput = false;
+    bool gstreamer = false;
+    bool headless = false;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--gray")
+            grayInput = true;
+        else if (arg == "--gst")
+            gstreamer = true;
+        else if (arg == "--headless")
+            headless = true;
+        else if (arg.compare(0, 2, "--") == 0) {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        } else
+            source = arg;
+    }
+
    // Validate that the dictionary ID is within the known range 0..16
-    cv::Ptr<cv::aruco::Dictionary> dictionary = 
+    cv::Ptr<cv::aruco::Dictionary> dictionary =
         cv::aruco::getPredefinedDictionary(cv::aruco::PREDEFINED_DICTIONARY_NAME(dictionary_id));
 
-    cv::VideoCapture inputVideo(0);
-    if (!inputVideo.isOpened()) {
+    cv::VideoCapture inputVideo;
+    GrayPath grayPath;
+    if (!openCapture(inputVideo, source, grayInput, gstreamer, &grayPath)) {
         std::cerr << "ERROR: Could not open video stream." << std::endl;
         return 1;
     }
 
     // Variables to hold the current frame from the camera and a copy for drawing
-    cv::Mat frame, imageCopy;
+    cv::Mat frame, gray, imageCopy;
     std::vector<int> ids;
     std::vector<std::vector<cv::Point2f>> corners;
 
+    // Wall-clock statistics for the headless summary (grab, decode, conversion and detection)
+    cv::TickMeter tm;
+    int frames = 0;
+    size_t markers = 0;
+
+    tm.start();
     while (inputVideo.grab()) {
-        // Retrieve (decode) the current frame
-        inputVideo.retrieve(frame);
-        // Make a copy of the original frame for drawing
-        frame.copyTo(imageCopy);
-        // Detect ArUco markers in the frame
-        cv::aruco::detectMarkers(frame, dictionary, corners, ids);
+        if (grayInput) {
+            // Retrieve the frame and detect on its single-channel view
+            if (!retrieveGray(inputVideo, frame, gray))
+                break;
+            cv::aruco::detectMarkers(gray, dictionary, corners, ids);
+        } else {
+            // Retrieve (decode) the current frame
+            inputVideo.retrieve(frame);
+            // Make a copy of the original frame for drawing
+            if (!headless)
+                frame.copyTo(imageCopy);
+            // Detect ArUco markers in the frame
+            cv::aruco::detectMarkers(frame, dictionary, corners, ids);
+        }
+        frames++;
+        markers += ids.size();
+
+        if (headless)
+            continue;
+
+        // Colour is only needed for the overlay
+        if (grayInput)
+            overlayImage(frame, imageCopy);
         // If any markers have been found, draw them on the copy
         if (!ids.empty()) {
             cv::aruco::drawDetectedMarkers(imageCopy, corners, ids);
         }
-        // Show the processed frame 
+        // Show the processed frame
         cv::imshow("Detected ArUco markers", imageCopy);
         if ((char)cv::waitKey(10) == 27) break; // ESC key to exit
     }
 
+    tm.stop();
+
+    if (headless) {
+        std::cout << "Frames: " << frames << ", markers detected: " << markers
+                  << ", wall-clock time per frame: " << (frames ? tm.getTimeMilli() / frames : 0.0) << " ms"
+                  << " (" << grayPathName(grayPath) << ", "
+                  << inputVideo.getBackendName() << " backend)" << std::endl;
+    }
+
     return 0;
 }
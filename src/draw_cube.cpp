@@ -4,6 +4,7 @@
 #include <opencv2/opencv.hpp> // For OpenCV operations (general)
 #include <vector> // For std::vector
 #include <cstdlib> // For C standard library functions
+#include "gray_capture.hpp" // For grayscale-native capture
 
 // Namespace for command-line options and default values
 namespace
@@ -11,7 +12,8 @@ namespace
     const char *keys =
         "{d        |16    | dictionary: DICT_ARUCO_ORIGINAL = 16}" // Dictionary type for ArUco markers
         "{l        |      | Actual marker length in meter }" // Marker length (user input)
-        "{v        |<none>| Custom video source, otherwise '0' }"; // Video source
+        "{v        |<none>| Custom video source, otherwise '0' }" // Video source
+        "{gray     |false | Detect on single-channel frames, colour only for display }"; // Grayscale input
 }
 
 // Function to draw a cube wireframe on the image
@@ -32,6 +34,7 @@ int main(int argc, char **argv)
 
     int dictionaryId = parser.get<int>("d"); // Get dictionary ID
     float marker_length_m = parser.get<float>("l"); // Get marker length
+    bool gray_input = parser.get<bool>("gray"); // Detect on grayscale frames
     int wait_time = 10; // Time to wait between frames (in ms)
 
     if (marker_length_m <= 0) // Validate marker length
@@ -42,16 +45,17 @@ int main(int argc, char **argv)
     }
 
     cv::String videoInput = "0"; // Default video source (webcam)
+    if (parser.has("v"))
+        videoInput = parser.get<cv::String>("v"); // Camera index or video file
     cv::VideoCapture in_video;
-    in_video.open(0); // Open the webcam
 
-    if (!in_video.isOpened()) // Check if video source is available
+    if (!openCapture(in_video, videoInput, gray_input)) // Check if video source is available
     {
         std::cerr << "failed to open video input: " << videoInput << std::endl;
         return 1;
     }
 
-    cv::Mat image, image_copy; // Matrices for frames and their copies
+    cv::Mat image, image_gray, image_copy; // Matrices for frames, detection input and drawing
     cv::Mat camera_matrix, dist_coeffs; // Camera calibration matrices
     std::ostringstream vector_to_marker; // To display marker info
 
@@ -77,11 +81,21 @@ int main(int argc, char **argv)
 
     while (in_video.grab()) // Grab frames from the video source
     {
-        in_video.retrieve(image); // Retrieve the current frame
-        image.copyTo(image_copy); // Create a copy for processing
         std::vector<int> ids; // IDs of detected markers
         std::vector<std::vector<cv::Point2f>> corners; // Corner points of detected markers
-        cv::aruco::detectMarkers(image, dictionary, corners, ids); // Detect markers
+        if (gray_input)
+        {
+            if (!retrieveGray(in_video, image, image_gray)) // Retrieve the current frame
+                break;
+            cv::aruco::detectMarkers(image_gray, dictionary, corners, ids); // Detect markers
+            overlayImage(image, image_copy); // Draw on the frame itself
+        }
+        else
+        {
+            in_video.retrieve(image); // Retrieve the current frame
+            image.copyTo(image_copy); // Create a copy for processing
+            cv::aruco::detectMarkers(image, dictionary, corners, ids); // Detect markers
+        }
 
         // If at least one marker is detected
         if (ids.size() > 0)
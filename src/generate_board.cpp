@@ -1,6 +1,13 @@
 #include <opencv2/highgui.hpp>
 #include <opencv2/aruco.hpp>
+#include <opencv2/core/utility.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cfloat>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <vector>
 
 using namespace cv;
 using namespace std;
@@ -8,13 +15,292 @@ using namespace std;
 namespace {
 const char* about = "Create an ArUco grid board image";
 const char* keys  =
-        "{@outfile |<none> | Output image }"
+        "{@outfile |<none> | Output image (.tif/.tiff is rendered strip by strip) }"
         "{r        |       | Number of markers in X direction }"
         "{c        |       | Number of markers in Y direction }"
         "{l        |       | Marker side length (in pixels) }"
         "{s        |       | Separation between two consecutive markers in the grid (in pixels)}"
         "{d        |       | Dictionary ID (e.g., DICT_4X4_50=0, DICT_ARUCO_ORIGINAL=16)}"
-        "{si       | false | Show generated image }";
+        "{ts       | 0     | Rows per strip for tiled output (0 = one marker row, at most 4 MB) }"
+        "{dpi      | 72    | Print resolution stored in tiled output (pixels per inch) }"
+        "{si       | false | Show generated image (tiled output only up to 64 Mpx) }";
+
+// Largest tiled output that is read back for display
+const double maxShowPixels = 64e6;
+
+// Memory budgets for tiled output: default strip size, and all strips rendered at once
+const size_t stripBudgetBytes = size_t(4) << 20;
+const size_t batchBudgetBytes = size_t(64) << 20;
+
+/**
+* @brief Renders horizontal strips of a bordered grid board without ever holding the full raster.
+*        Marker placement follows the same object-to-pixel mapping as Board::draw.
+*/
+class TiledBoardRenderer {
+public:
+    TiledBoardRenderer(const Ptr<aruco::GridBoard> &board, int markerSize, int borderSize)
+        : board_(board), markerSize_(markerSize), borderSize_(borderSize) {
+        // Board extent in object units, as computed by Board::draw
+        float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX;
+        for (size_t m = 0; m < board_->objPoints.size(); m++) {
+            for (size_t j = 0; j < board_->objPoints[m].size(); j++) {
+                minX = min(minX, board_->objPoints[m][j].x);
+                maxX = max(maxX, board_->objPoints[m][j].x);
+                minY = min(minY, board_->objPoints[m][j].y);
+                maxY = max(maxY, board_->objPoints[m][j].y);
+            }
+        }
+        boardSize_ = Size(cvRound(maxX - minX), cvRound(maxY - minY));
+
+        // Top-left pixel of every marker inside the bordered image (object Y axis points up)
+        for (size_t m = 0; m < board_->objPoints.size(); m++) {
+            const Point3f &tl = board_->objPoints[m][0];
+            markerOrigins_.push_back(Point(borderSize_ + cvRound(tl.x - minX),
+                                           borderSize_ + cvRound(maxY - tl.y)));
+        }
+
+        // Every marker is drawn once at one pixel per bit cell; strips expand only the rows they need
+        int cells = board_->dictionary->markerSize + 2;
+        markerCells_.resize(board_->ids.size());
+        for (size_t m = 0; m < board_->ids.size(); m++)
+            board_->dictionary->drawMarker(board_->ids[m], cells, markerCells_[m], 1);
+
+        // Pixel to cell mapping of the INTER_NEAREST resize used by drawMarker
+        double scale = 1. / (double(markerSize_) / cells);
+        cellOffsets_.resize(markerSize_);
+        for (int i = 0; i < markerSize_; i++)
+            cellOffsets_[i] = min(cvFloor(i * scale), cells - 1);
+    }
+
+    Size imageSize() const {
+        return Size(boardSize_.width + 2 * borderSize_, boardSize_.height + 2 * borderSize_);
+    }
+
+    // Fill 'strip' with image rows [y0, y0 + strip.rows) of the bordered board
+    void renderStrip(int y0, Mat &strip) const {
+        CV_Assert(strip.type() == CV_8UC1 && strip.cols == imageSize().width);
+        strip.setTo(Scalar::all(255));
+        int y1 = y0 + strip.rows;
+
+        for (size_t m = 0; m < markerOrigins_.size(); m++) {
+            const Point &origin = markerOrigins_[m];
+            int top = max(origin.y, y0);
+            int bottom = min(origin.y + markerSize_, y1);
+            if (top >= bottom)
+                continue;
+
+            for (int y = top; y < bottom; y++) {
+                const uchar *cellRow = markerCells_[m].ptr(cellOffsets_[y - origin.y]);
+                uchar *dst = strip.ptr(y - y0) + origin.x;
+                for (int x = 0; x < markerSize_; x++)
+                    dst[x] = cellRow[cellOffsets_[x]];
+            }
+        }
+    }
+
+private:
+    Ptr<aruco::GridBoard> board_;
+    int markerSize_;
+    int borderSize_;
+    Size boardSize_;
+    vector<Point> markerOrigins_;
+    vector<Mat> markerCells_;
+    vector<int> cellOffsets_;
+};
+
+/**
+* @brief PackBits-compresses a strip row by row (TIFF compression 32773).
+*        Runs of three or more equal bytes become repeat packets, everything else literal packets.
+*/
+void packBitsStrip(const Mat &strip, vector<uchar> &packed) {
+    packed.clear();
+    for (int y = 0; y < strip.rows; y++) {
+        const uchar *row = strip.ptr(y);
+        int n = strip.cols;
+        int i = 0;
+        while (i < n) {
+            int j = i + 1;
+            while (j < n && j - i < 128 && row[j] == row[i])
+                j++;
+            if (j - i >= 3) {
+                packed.push_back(uchar(1 - (j - i)));
+                packed.push_back(row[i]);
+                i = j;
+                continue;
+            }
+
+            // Literal packet up to the next run of three
+            j = i;
+            while (j < n && j - i < 128 &&
+                   !(j + 2 < n && row[j] == row[j + 1] && row[j] == row[j + 2]))
+                j++;
+            packed.push_back(uchar(j - i - 1));
+            packed.insert(packed.end(), row + i, row + j);
+            i = j;
+        }
+    }
+}
+
+/**
+* @brief Minimal baseline TIFF writer (8-bit grayscale, PackBits, one strip per write)
+*        that streams strips to disk and emits the directory once the image is complete.
+*/
+class TiffStripWriter {
+public:
+    TiffStripWriter(const string &filename, Size imageSize, int rowsPerStrip, int dpi)
+        : file_(filename.c_str(), ios::binary | ios::trunc),
+          imageSize_(imageSize), rowsPerStrip_(rowsPerStrip), dpi_(dpi) {
+        // Little-endian header; the IFD offset is patched in close()
+        static const char header[8] = { 'I', 'I', 42, 0, 0, 0, 0, 0 };
+        file_.write(header, sizeof(header));
+    }
+
+    bool isOpened() const { return file_.good(); }
+
+    // 'packed' is a strip compressed by packBitsStrip()
+    bool writeStrip(const vector<uchar> &packed) {
+        stripOffsets_.push_back(uint32_t(streamoff(file_.tellp())));
+        stripByteCounts_.push_back(uint32_t(packed.size()));
+        file_.write(reinterpret_cast<const char*>(packed.data()), packed.size());
+        return file_.good();
+    }
+
+    bool close() {
+        // A TIFF needs at least one strip
+        if (stripOffsets_.empty()) {
+            file_.close();
+            return false;
+        }
+
+        // The IFD must start on a word boundary
+        if (streamoff(file_.tellp()) % 2)
+            file_.put(0);
+
+        // Strip tables are stored out of line when there is more than one strip
+        uint32_t offsetsPos = uint32_t(streamoff(file_.tellp()));
+        uint32_t countsPos = offsetsPos + 4 * uint32_t(stripOffsets_.size());
+        bool outOfLine = stripOffsets_.size() > 1;
+        if (outOfLine) {
+            for (size_t i = 0; i < stripOffsets_.size(); i++) put32(stripOffsets_[i]);
+            for (size_t i = 0; i < stripByteCounts_.size(); i++) put32(stripByteCounts_[i]);
+        }
+
+        // X and Y resolution as RATIONAL (dpi / 1)
+        uint32_t resolutionPos = uint32_t(streamoff(file_.tellp()));
+        for (int i = 0; i < 2; i++) {
+            put32(uint32_t(dpi_));
+            put32(1);
+        }
+
+        uint32_t ifdPos = uint32_t(streamoff(file_.tellp()));
+        uint32_t stripCount = uint32_t(stripOffsets_.size());
+        put16(12);
+        putEntry(256, 4, 1, uint32_t(imageSize_.width));        // ImageWidth
+        putEntry(257, 4, 1, uint32_t(imageSize_.height));       // ImageLength
+        putEntry(258, 3, 1, 8);                                 // BitsPerSample
+        putEntry(259, 3, 1, 32773);                             // Compression: PackBits
+        putEntry(262, 3, 1, 1);                                 // Photometric: BlackIsZero
+        putEntry(273, 4, stripCount, outOfLine ? offsetsPos : stripOffsets_[0]);
+        putEntry(277, 3, 1, 1);                                 // SamplesPerPixel
+        putEntry(278, 4, 1, uint32_t(rowsPerStrip_));           // RowsPerStrip
+        putEntry(279, 4, stripCount, outOfLine ? countsPos : stripByteCounts_[0]);
+        putEntry(282, 5, 1, resolutionPos);                     // XResolution
+        putEntry(283, 5, 1, resolutionPos + 8);                 // YResolution
+        putEntry(296, 3, 1, 2);                                 // ResolutionUnit: inch
+        put32(0);                                               // No further IFDs
+
+        file_.seekp(4);
+        put32(ifdPos);
+        file_.close();
+        return !file_.fail();
+    }
+
+private:
+    void put16(uint16_t v) {
+        char b[2] = { char(v & 0xff), char(v >> 8) };
+        file_.write(b, 2);
+    }
+
+    void put32(uint32_t v) {
+        char b[4] = { char(v & 0xff), char((v >> 8) & 0xff), char((v >> 16) & 0xff), char(v >> 24) };
+        file_.write(b, 4);
+    }
+
+    // SHORT values are left-justified in the 4-byte value field
+    void putEntry(uint16_t tag, uint16_t type, uint32_t count, uint32_t value) {
+        put16(tag);
+        put16(type);
+        put32(count);
+        if (type == 3 && count == 1) {
+            put16(uint16_t(value));
+            put16(0);
+        } else {
+            put32(value);
+        }
+    }
+
+    ofstream file_;
+    Size imageSize_;
+    int rowsPerStrip_;
+    int dpi_;
+    vector<uint32_t> stripOffsets_;
+    vector<uint32_t> stripByteCounts_;
+};
+
+bool isTiffFile(const string &filename) {
+    string ext = filename.substr(filename.find_last_of('.') + 1);
+    transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == "tif" || ext == "tiff";
+}
+
+/**
+* @brief Renders and compresses the board in batches of strips (one per worker thread) and streams them to a TIFF.
+*        The batch is capped by batchBudgetBytes, so peak memory is independent of board size and core count.
+*/
+bool writeTiledBoard(const string &filename, const TiledBoardRenderer &renderer, int rowsPerStrip, int dpi) {
+    Size imageSize = renderer.imageSize();
+    // Worst case PackBits output is one header byte per 128 data bytes, plus one per row
+    uint64_t rowBytes = uint64_t(imageSize.width) + (imageSize.width + 127) / 128;
+    if (rowBytes * uint64_t(imageSize.height) > uint64_t(UINT32_MAX) - (1 << 20)) {
+        cerr << "Error: Board is too large for a classic TIFF file." << endl;
+        return false;
+    }
+
+    TiffStripWriter writer(filename, imageSize, rowsPerStrip, dpi);
+    if (!writer.isOpened())
+        return false;
+
+    int stripCount = (imageSize.height + rowsPerStrip - 1) / rowsPerStrip;
+    // Each strip in flight holds its raster plus up to the same again in PackBits output
+    size_t stripBytes = 2 * size_t(imageSize.width) * size_t(rowsPerStrip);
+    int batchSize = int(min<size_t>(size_t(max(1, getNumThreads())), max<size_t>(1, batchBudgetBytes / stripBytes)));
+    vector<Mat> strips(batchSize);
+    vector<vector<uchar> > packed(batchSize);
+
+    for (int first = 0; first < stripCount; first += batchSize) {
+        int last = min(first + batchSize, stripCount);
+
+        // Render the strips of this batch in parallel
+        parallel_for_(Range(first, last), [&](const Range &range) {
+            for (int i = range.start; i < range.end; i++) {
+                int y0 = i * rowsPerStrip;
+                int rows = min(rowsPerStrip, imageSize.height - y0);
+                Mat &strip = strips[i - first];
+                strip.create(rows, imageSize.width, CV_8UC1);
+                renderer.renderStrip(y0, strip);
+                packBitsStrip(strip, packed[i - first]);
+            }
+        });
+
+        // Write them back in order
+        for (int i = first; i < last; i++) {
+            if (!writer.writeStrip(packed[i - first]))
+                return false;
+        }
+    }
+
+    return writer.close();
+}
 }
 
 int main(int argc, char *argv[]) {
@@ -31,6 +317,8 @@ int main(int argc, char *argv[]) {
     int markerSize = parser.get<int>("l"); // Marker size
     int markerSeparation = parser.get<int>("s"); // Marker separation
     int dictionaryId = parser.get<int>("d"); // Dictionary ID
+    int rowsPerStrip = parser.get<int>("ts"); // Strip height for tiled output
+    int dpi = parser.get<int>("dpi"); // Print resolution for tiled output
     bool showImage = parser.get<bool>("si"); // Show image flag
     String out = parser.get<String>(0); // Output file
 
@@ -52,14 +340,45 @@ int main(int argc, char *argv[]) {
     Ptr<aruco::GridBoard> board = aruco::GridBoard::create(
         markersC, markersR, float(markerSize), float(markerSeparation), dictionary);
 
-    // Draw the board
-    Mat boardImage;
-    board->draw(imageSize, boardImage);
-
-    // Add a white border around the entire board
+    // White border around the entire board
     int borderSize = markerSize / 2; // Adjust the border size as needed
-    Mat borderedImage(imageSize.height + 2 * borderSize, imageSize.width + 2 * borderSize, boardImage.type(), Scalar(255, 255, 255));
-    boardImage.copyTo(borderedImage(Rect(borderSize, borderSize, imageSize.width, imageSize.height)));
+
+    // Large boards: render strip by strip and stream to a TIFF file
+    if (isTiffFile(out)) {
+        if (dpi <= 0) {
+            cerr << "Error: dpi must be a positive value." << endl;
+            return -1;
+        }
+
+        TiledBoardRenderer renderer(board, markerSize, borderSize);
+        if (rowsPerStrip <= 0) {
+            int budgetRows = int(max<size_t>(1, stripBudgetBytes / size_t(renderer.imageSize().width)));
+            rowsPerStrip = min(markerSize + markerSeparation, budgetRows);
+        }
+        rowsPerStrip = min(rowsPerStrip, renderer.imageSize().height); // Keeps strip arithmetic in range
+        if (!writeTiledBoard(out, renderer, rowsPerStrip, dpi)) {
+            cerr << "Error: Failed to save the board image." << endl;
+            return -1;
+        }
+
+        cout << "ArUco board generated and saved as " << out << endl;
+        // Small boards fit in memory, so read them back for display
+        if (showImage) {
+            Size tiledSize = renderer.imageSize();
+            if (double(tiledSize.width) * tiledSize.height > maxShowPixels) {
+                cout << "Board is too large to display; open " << out << " instead." << endl;
+            } else {
+                imshow("board", imread(out, IMREAD_GRAYSCALE));
+                waitKey(0);
+            }
+        }
+        return 0;
+    }
+
+    // Draw the board straight into the bordered image to avoid a second full-size buffer
+    Mat borderedImage(imageSize.height + 2 * borderSize, imageSize.width + 2 * borderSize, CV_8UC1, Scalar::all(255));
+    Mat boardImage = borderedImage(Rect(borderSize, borderSize, imageSize.width, imageSize.height));
+    board->draw(imageSize, boardImage);
 
     // Save the board image
     if (!imwrite(out, borderedImage)) {
@@ -76,4 +395,4 @@ int main(int argc, char *argv[]) {
     }
 
     return 0;
-}
\ No newline at end of file
+}
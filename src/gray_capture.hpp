@@ -0,0 +1,154 @@
+#ifndef GRAY_CAPTURE_HPP
+#define GRAY_CAPTURE_HPP
+
+#include <opencv2/videoio.hpp>
+#include <opencv2/imgproc.hpp>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/**
+* @brief Tells camera indices ("0", "-1", ...) apart from file names and parses them.
+* @param source  Camera index or video file path
+* @param index   Parsed camera index
+* @param invalid Set when 'source' looks like an index but does not fit in an int
+* @return true if 'source' is a valid camera index
+*/
+static inline bool parseCameraIndex(const std::string &source, int &index, bool &invalid) {
+    invalid = false;
+    size_t start = (!source.empty() && source[0] == '-') ? 1 : 0;
+    if (source.size() == start || source.find_first_not_of("0123456789", start) != std::string::npos)
+        return false;
+
+    errno = 0;
+    long value = std::strtol(source.c_str(), 0, 10);
+    if (errno == ERANGE || value < INT_MIN || value > INT_MAX) {
+        invalid = true;
+        return false;
+    }
+    index = int(value);
+    return true;
+}
+
+// How single-channel frames are obtained in grayscale mode
+enum GrayPath {
+    GRAY_PATH_NONE,     // Colour mode
+    GRAY_PATH_DECODER,  // GStreamer hands back the decoder's luma plane (GRAY8)
+    GRAY_PATH_YUYV,     // Raw V4L2 YUYV frames; luma is extracted, no colour conversion
+    GRAY_PATH_CPU       // BGR decode plus cvtColor: no savings over colour mode
+};
+
+static inline const char *grayPathName(GrayPath path) {
+    switch (path) {
+    case GRAY_PATH_DECODER: return "GRAY8 from decoder";
+    case GRAY_PATH_YUYV:    return "luma from raw YUYV";
+    case GRAY_PATH_CPU:     return "BGR converted on CPU, no savings over colour mode";
+    default:                return "colour";
+    }
+}
+
+/**
+* @brief Opens a camera index ("0", "-1", ...) or a video file.
+*        In grayscale mode single-channel frames are requested wherever the backend allows:
+*        a GStreamer pipeline producing GRAY8 first, then raw YUYV from V4L2 cameras.
+*        Otherwise frames are decoded to BGR and a notice says that this saves nothing.
+* @param cap        Capture to open
+* @param source     Camera index or video file path
+* @param gray       Request single-channel frames
+* @param gstreamer  Also use the GStreamer pipeline (with BGR output) in colour mode,
+*                   so both modes can be compared on the same backend
+* @param path       Optional, receives how grayscale frames are obtained
+* @return true if the source could be opened
+*/
+static inline bool openCapture(cv::VideoCapture &cap, const std::string &source, bool gray,
+                               bool gstreamer = false, GrayPath *path = 0) {
+    GrayPath unused;
+    if (!path)
+        path = &unused;
+    *path = gray ? GRAY_PATH_CPU : GRAY_PATH_NONE;
+
+    int index = 0;
+    bool invalidIndex = false;
+    bool isCamera = parseCameraIndex(source, index, invalidIndex);
+    if (invalidIndex) {
+        std::cerr << "Invalid camera index: " << source << std::endl;
+        return false;
+    }
+
+    // Negative indices ("any camera") have no /dev/video device to hand to GStreamer
+    if ((gray || gstreamer) && !(isCamera && index < 0)) {
+        const char *format = gray ? "GRAY8" : "BGR";
+        // Quotes and backslashes would break the quoted location in the pipeline description
+        if (!isCamera && source.find_first_of("\"\\") != std::string::npos) {
+            std::cerr << "Notice: video path contains quotes or backslashes, not using GStreamer" << std::endl;
+        } else {
+            std::string pipeline = isCamera
+                ? "v4l2src device=/dev/video" + std::to_string(index) + " ! videoconvert ! video/x-raw,format=" + format + " ! appsink drop=true"
+                : "filesrc location=\"" + source + "\" ! decodebin ! videoconvert ! video/x-raw,format=" + format + " ! appsink sync=false";
+            if (cap.open(pipeline, cv::CAP_GSTREAMER)) {
+                if (gray)
+                    *path = GRAY_PATH_DECODER;
+                return true;
+            }
+            std::cerr << "Notice: GStreamer pipeline unavailable, using the default backend" << std::endl;
+        }
+    }
+
+    if (!(isCamera ? cap.open(index) : cap.open(source)))
+        return false;
+
+    // V4L2 cameras: keep raw YUYV frames, whose luma plane needs no colour conversion
+    if (gray && isCamera && cap.getBackendName() == "V4L2") {
+        const int yuyv = cv::VideoWriter::fourcc('Y', 'U', 'Y', 'V');
+        if (int(cap.get(cv::CAP_PROP_FOURCC)) != yuyv)
+            cap.set(cv::CAP_PROP_FOURCC, yuyv);
+        if (int(cap.get(cv::CAP_PROP_FOURCC)) == yuyv && cap.set(cv::CAP_PROP_CONVERT_RGB, 0)) {
+            *path = GRAY_PATH_YUYV;
+            return true;
+        }
+        cap.set(cv::CAP_PROP_CONVERT_RGB, 1);
+    }
+
+    if (gray)
+        std::cerr << "Notice: no native grayscale source; frames are decoded to BGR and converted on the CPU, "
+                     "which saves nothing over colour mode" << std::endl;
+    return true;
+}
+
+/**
+* @brief Retrieves the grabbed frame and provides a single-channel view for detection.
+*        Frames that are already single-channel are used as is, raw YUYV frames give up their
+*        luma plane, and colour frames are converted once, so detectMarkers does not have to.
+* @param cap   Capture with a grabbed frame
+* @param frame Frame as delivered by the backend (colour, YUYV or grayscale)
+* @param gray  Single-channel frame for detection (shares data with 'frame' when possible)
+* @return false if no frame could be retrieved
+*/
+static inline bool retrieveGray(cv::VideoCapture &cap, cv::Mat &frame, cv::Mat &gray) {
+    if (!cap.retrieve(frame) || frame.empty())
+        return false;
+    if (frame.channels() == 1)
+        gray = frame;
+    else if (frame.channels() == 2)
+        cv::cvtColor(frame, gray, cv::COLOR_YUV2GRAY_YUY2);
+    else
+        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+    return true;
+}
+
+/**
+* @brief Returns a colour image to draw the display/recording overlay on.
+*        Colour frames are drawn on in place (no copy); grayscale and YUYV frames are expanded only here.
+*/
+static inline void overlayImage(cv::Mat &frame, cv::Mat &overlay) {
+    if (frame.channels() == 1)
+        cv::cvtColor(frame, overlay, cv::COLOR_GRAY2BGR);
+    else if (frame.channels() == 2)
+        cv::cvtColor(frame, overlay, cv::COLOR_YUV2BGR_YUY2);
+    else
+        overlay = frame;
+}
+
+#endif // GRAY_CAPTURE_HPP
@@ -1,6 +1,7 @@
 #include <opencv2/opencv.hpp>
 #include <opencv2/aruco.hpp>
 #include <iostream>
+#include "gray_capture.hpp"
 
 using namespace cv;
 using namespace std;
@@ -19,6 +20,8 @@ int main(int argc, char **argv) {
         "{l|0.05|Marker length (meters)}"
         "{id|0|Target marker ID}"
         "{calib||Calibration file}"
+        "{v|0|Camera index or video file}"
+        "{gray|false|Detect on single-channel frames, colour only for display}"
         "{help||Show help}");
     
     if (parser.has("help")) {
@@ -30,6 +33,8 @@ int main(int argc, char **argv) {
     float markerLength = parser.get<float>("l");
     int targetId = parser.get<int>("id");
     string calibFile = parser.get<string>("calib");
+    string videoSource = parser.get<string>("v");
+    bool grayInput = parser.get<bool>("gray");
 
     if (calibFile.empty()) {
         cerr << "Error: Calibration file not specified! Use -calib to provide the file path." << endl;
@@ -50,8 +55,8 @@ int main(int argc, char **argv) {
     fs["distortion_coefficients"] >> distCoeffs;
 
     // Video capture
-    VideoCapture cap(0);
-    if (!cap.isOpened()) {
+    VideoCapture cap;
+    if (!openCapture(cap, videoSource, grayInput)) {
         cerr << "Failed to open video stream" << endl;
         return 1;
     }
@@ -62,14 +67,22 @@ int main(int argc, char **argv) {
     Ptr<aruco::DetectorParameters> detectorParams = aruco::DetectorParameters::create();
 
     while (cap.grab()) {
-        Mat image, imageCopy;
-        cap.retrieve(image);
-        image.copyTo(imageCopy);
-
-        // Marker detection
+        Mat image, gray, imageCopy;
         vector<int> ids;
         vector<vector<Point2f>> corners;
-        aruco::detectMarkers(image, dictionary, corners, ids, detectorParams);
+
+        // Marker detection
+        if (grayInput) {
+            // Detect on the single-channel frame; draw on the frame itself
+            if (!retrieveGray(cap, image, gray))
+                break;
+            aruco::detectMarkers(gray, dictionary, corners, ids, detectorParams);
+            overlayImage(image, imageCopy);
+        } else {
+            cap.retrieve(image);
+            image.copyTo(imageCopy);
+            aruco::detectMarkers(image, dictionary, corners, ids, detectorParams);
+        }
 
         // Pose estimation
         if (!ids.empty()) {